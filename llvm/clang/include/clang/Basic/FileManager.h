@@ -73,13 +73,49 @@ public:
   }
 };
 
-// FIXME: This is a lightweight shim that is used by FileManager to cache
-//  'stat' system calls.  We will use it with PTH to identify if caching
-//  stat calls in PTH files is a performance win.
+/// \brief Abstract interface for introducing a FileManager cache for 'stat'
+/// system calls, which is used by precompiled and pretokenized headers to
+/// improve performance.
+///
+/// Stat caches form a chain: a cache that cannot answer a query forwards it
+/// to the next cache in the chain via statChained(), and the last cache in
+/// the chain falls back to the real 'stat' system call.  This allows, e.g.,
+/// the stat caches of a PTH file and a PCH file to be used together, and a
+/// MemorizeStatCalls listener to observe the results of both.
 class StatSysCallCache {
+protected:
+  llvm::OwningPtr<StatSysCallCache> NextStatCache;
+
 public:
   virtual ~StatSysCallCache() {}
-  virtual int stat(const char *path, struct stat *buf) = 0;
+  virtual int stat(const char *path, struct stat *buf) {
+    return statChained(path, buf);
+  }
+
+  /// \brief Retrieve the next stat call cache in the chain.
+  StatSysCallCache *getNextStatCache() { return NextStatCache.get(); }
+
+  /// \brief Retrieve the next stat call cache in the chain, transferring
+  /// ownership of this cache (and, transitively, all of the remaining caches)
+  /// to the caller.
+  StatSysCallCache *takeNextStatCache() { return NextStatCache.take(); }
+
+  /// \brief Set the next stat call cache in the chain.  Ownership of the
+  /// cache is transferred to this object.
+  void setNextStatCache(StatSysCallCache *Cache) {
+    NextStatCache.reset(Cache);
+  }
+
+protected:
+  /// \brief Answer a 'stat' query this cache could not satisfy itself, by
+  /// forwarding it to the next cache in the chain or, if there is none, to
+  /// the 'stat' system call.
+  int statChained(const char *path, struct stat *buf) {
+    if (StatSysCallCache *Next = getNextStatCache())
+      return Next->stat(path, buf);
+
+    return ::stat(path, buf);
+  }
 };
 
 /// \brief A stat listener that can be used by FileManager to keep
@@ -146,12 +182,21 @@ public:
   FileManager();
   ~FileManager();
 
-  /// setStatCache - Installs the provided StatSysCallCache object within
-  ///  the FileManager.  Ownership of this object is transferred to the
-  ///  FileManager.
-  void setStatCache(StatSysCallCache *statCache) {
-    StatCache.reset(statCache);
-  }
+  /// \brief Installs the provided StatSysCallCache object within
+  /// the FileManager.
+  ///
+  /// \param statCache the new stat cache to install. Ownership of this
+  /// object is transferred to the FileManager.
+  ///
+  /// \param AtBeginning whether this new stat cache must be installed at the
+  /// beginning of the chain of stat caches. Otherwise, it will be added to
+  /// the end of the chain.
+  void addStatCache(StatSysCallCache *statCache, bool AtBeginning = false);
+
+  /// \brief Removes the provided StatSysCallCache object from the file
+  /// manager, destroying it.  Any caches that followed it in the chain are
+  /// kept.
+  void removeStatCache(StatSysCallCache *statCache);
   
   /// getDirectory - Lookup, cache, and verify the specified directory.  This
   /// returns null if the directory doesn't exist.
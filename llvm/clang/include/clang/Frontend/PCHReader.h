@@ -53,6 +53,7 @@ class LabelStmt;
 class NamedDecl;
 class Preprocessor;
 class Sema;
+class StatSysCallCache;
 class SwitchCase;
 class PCHReader;
 struct HeaderFileInfo;
@@ -335,6 +336,10 @@ private:
   /// been de-serialized.
   std::multimap<unsigned, AddrLabelExpr *> UnresolvedAddrLabelExprs;
 
+  /// \brief The stat cache built from the PCH file, which is owned by the
+  /// FileManager.
+  StatSysCallCache *StatCache;
+
   /// \brief The number of stat() calls that hit/missed the stat
   /// cache.
   unsigned NumStatHits, NumStatMisses;
@@ -343,6 +348,15 @@ private:
   /// the PCH file.
   unsigned NumSLocEntriesRead;
 
+  /// \brief The number of types and declarations de-serialized from the
+  /// PCH file.
+  unsigned NumTypesRead, NumDeclsRead;
+
+  /// \brief The number of types and declarations that had already been
+  /// de-serialized when the PCH file was attached to Sema, i.e., the
+  /// ones read eagerly rather than on demand during parsing.
+  unsigned NumTypesReadAtInit, NumDeclsReadAtInit;
+
   /// \brief The number of statements (and expressions) de-serialized
   /// from the PCH file.
   unsigned NumStatementsRead;
@@ -622,6 +636,10 @@ public:
   virtual std::pair<ObjCMethodList, ObjCMethodList> 
     ReadMethodPool(Selector Sel);
 
+  /// \brief Load the ext_vector type declarations stored in the PCH
+  /// file.
+  virtual void ReadExtVectorDecls(llvm::SmallVectorImpl<TypedefDecl *> &Decls);
+
   void SetIdentifierInfo(unsigned ID, IdentifierInfo *II);
   void SetGloballyVisibleDecls(IdentifierInfo *II, 
                                const llvm::SmallVectorImpl<uint32_t> &DeclIDs,
@@ -213,6 +213,15 @@ public:
   static unsigned MeasureTokenLength(SourceLocation Loc,
                                      const SourceManager &SM,
                                      const LangOptions &LangOpts);
+
+  /// ComputePreamble - Determine the size, in bytes, of the preamble of the
+  /// given buffer: the leading run of comments and preprocessor directives
+  /// (#include, #define, balanced #if/#endif blocks, etc.) that comes before
+  /// the first token of real code.  Tools that parse the same file over and
+  /// over can precompile this prefix once and reuse it as long as it, and the
+  /// headers it includes, do not change.
+  static unsigned ComputePreamble(const char *BufStart, const char *BufEnd,
+                                  const LangOptions &LangOpts);
   
   //===--------------------------------------------------------------------===//
   // Internal implementation interfaces.
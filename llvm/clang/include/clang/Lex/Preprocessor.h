@@ -32,6 +32,7 @@ namespace clang {
   
 class SourceManager;
 class FileManager;
+class StatSysCallCache;
 class FileEntry;
 class HeaderSearch;
 class PragmaNamespace;
@@ -59,6 +60,10 @@ class Preprocessor {
   /// PTH - An optional PTHManager object used for getting tokens from
   ///  a token cache rather than lexing the original source file.
   llvm::OwningPtr<PTHManager> PTH;
+
+  /// PTHStatCache - The stat cache that PTH installed in the FileManager, if
+  ///  any.  It refers to PTH's data, so it is removed along with PTH.
+  StatSysCallCache *PTHStatCache;
   
   /// BP - A BumpPtrAllocator object used to quickly allocate and release
   ///  objects internal to the Preprocessor.
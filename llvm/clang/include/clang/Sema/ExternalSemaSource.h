@@ -15,6 +15,7 @@
 
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/ExternalASTSource.h"
+#include "llvm/ADT/SmallVector.h"
 
 namespace clang {
 
@@ -43,6 +44,15 @@ public:
   ReadMethodPool(Selector Sel) { 
     return std::pair<ObjCMethodList, ObjCMethodList>();
   }
+
+  /// \brief Load the ext_vector type declarations known to the external
+  /// source.
+  ///
+  /// Sema only needs these to give ext_vector element accesses their
+  /// typedef'd names, so they are requested the first time that happens
+  /// rather than when the external source is attached.
+  virtual void ReadExtVectorDecls(llvm::SmallVectorImpl<TypedefDecl *> &Decls) {
+  }
   
   // isa/cast/dyn_cast support
   static bool classof(const ExternalASTSource *Source) { 
@@ -147,6 +147,45 @@ FileManager::~FileManager() {
   delete &UniqueFiles;
 }
 
+void FileManager::addStatCache(StatSysCallCache *statCache, bool AtBeginning) {
+  assert(statCache && "No stat cache provided?");
+  if (AtBeginning || StatCache.get() == 0) {
+    statCache->setNextStatCache(StatCache.take());
+    StatCache.reset(statCache);
+    return;
+  }
+
+  StatSysCallCache *LastCache = StatCache.get();
+  while (LastCache->getNextStatCache())
+    LastCache = LastCache->getNextStatCache();
+
+  LastCache->setNextStatCache(statCache);
+}
+
+void FileManager::removeStatCache(StatSysCallCache *statCache) {
+  if (!statCache)
+    return;
+
+  if (StatCache.get() == statCache) {
+    // This is the first stat cache.
+    StatCache.reset(StatCache->takeNextStatCache());
+    return;
+  }
+
+  // Find the stat cache in the list.
+  StatSysCallCache *PrevCache = StatCache.get();
+  while (PrevCache && PrevCache->getNextStatCache() != statCache)
+    PrevCache = PrevCache->getNextStatCache();
+
+  assert(PrevCache && "Stat cache not found for removal");
+
+  // Unlink the cache from the chain, keeping the caches that follow it, and
+  // destroy it.
+  StatSysCallCache *RemovedCache = PrevCache->takeNextStatCache();
+  PrevCache->setNextStatCache(RemovedCache->takeNextStatCache());
+  delete RemovedCache;
+}
+
 /// getDirectory - Lookup, cache, and verify the specified directory.  This
 /// returns null if the directory doesn't exist.
 /// 
@@ -288,7 +327,7 @@ void FileManager::PrintStats() const {
 }
 
 int MemorizeStatCalls::stat(const char *path, struct stat *buf) {
-  int result = ::stat(path, buf);
+  int result = statChained(path, buf);
     
   if (result != 0) { 
     // Cache failed 'stat' results.
@@ -259,6 +259,8 @@ SourceManager::~SourceManager() {
 void SourceManager::clearIDTables() {
   MainFileID = FileID();
   SLocEntryTable.clear();
+  SLocEntryLoaded.clear();
+  ExternalSLocEntries = 0;
   LastLineNoFileIDQuery = FileID();
   LastLineNoContentCache = 0;
   LastFileIDLookup = FileID();
@@ -41,6 +41,7 @@ namespace {
     explicit PCHGenerator(const Preprocessor &PP, 
                           const char *isysroot,
                           llvm::raw_ostream *Out);
+    ~PCHGenerator();
     virtual void InitializeSema(Sema &S) { SemaPtr = &S; }
     virtual void HandleTranslationUnit(ASTContext &Ctx);
   };
@@ -54,7 +55,12 @@ PCHGenerator::PCHGenerator(const Preprocessor &PP,
   // Install a stat() listener to keep track of all of the stat()
   // calls.
   StatCalls = new MemorizeStatCalls;
-  PP.getFileManager().setStatCache(StatCalls);
+  PP.getFileManager().addStatCache(StatCalls, /*AtBeginning=*/true);
+}
+
+PCHGenerator::~PCHGenerator() {
+  // Stop recording stat() calls; the FileManager may outlive this PCH.
+  PP.getFileManager().removeStatCache(StatCalls);
 }
 
 void PCHGenerator::HandleTranslationUnit(ASTContext &Ctx) {
@@ -346,8 +346,9 @@ PCHReader::PCHReader(Preprocessor &PP, ASTContext *Context,
     MethodPoolLookupTable(0), MethodPoolLookupTableData(0),
     TotalSelectorsInMethodPool(0), SelectorOffsets(0),
     TotalNumSelectors(0), Comments(0), NumComments(0), isysroot(isysroot),
-    NumStatHits(0), NumStatMisses(0), 
-    NumSLocEntriesRead(0), NumStatementsRead(0), 
+    StatCache(0), NumStatHits(0), NumStatMisses(0), 
+    NumSLocEntriesRead(0), NumTypesRead(0), NumDeclsRead(0),
+    NumTypesReadAtInit(0), NumDeclsReadAtInit(0), NumStatementsRead(0), 
     NumMacrosRead(0), NumMethodPoolSelectorsRead(0), NumMethodPoolMisses(0),
     NumLexicalDeclContextsRead(0), NumVisibleDeclContextsRead(0),
     CurrentlyLoadingTypeOrDecl(0) { 
@@ -363,15 +364,19 @@ PCHReader::PCHReader(SourceManager &SourceMgr, FileManager &FileMgr,
     MethodPoolLookupTable(0), MethodPoolLookupTableData(0),
     TotalSelectorsInMethodPool(0), SelectorOffsets(0),
     TotalNumSelectors(0), Comments(0), NumComments(0), isysroot(isysroot),
-    NumStatHits(0), NumStatMisses(0), 
-    NumSLocEntriesRead(0), NumStatementsRead(0), 
+    StatCache(0), NumStatHits(0), NumStatMisses(0), 
+    NumSLocEntriesRead(0), NumTypesRead(0), NumDeclsRead(0),
+    NumTypesReadAtInit(0), NumDeclsReadAtInit(0), NumStatementsRead(0), 
     NumMacrosRead(0), NumMethodPoolSelectorsRead(0), NumMethodPoolMisses(0),
     NumLexicalDeclContextsRead(0), NumVisibleDeclContextsRead(0),
     CurrentlyLoadingTypeOrDecl(0) { 
   RelocatablePCH = false;
 }
 
-PCHReader::~PCHReader() {}
+PCHReader::~PCHReader() {
+  // The stat cache refers to the PCH file's data, which goes away with us.
+  FileMgr.removeStatCache(StatCache);
+}
 
 Expr *PCHReader::ReadDeclExpr() {
   return dyn_cast_or_null<Expr>(ReadStmt(DeclsCursor));
@@ -789,7 +794,7 @@ public:
     // If we don't get a hit in the PCH file just forward to 'stat'.
     if (I == Cache->end()) {
       ++NumStatMisses;
-      return ::stat(path, buf);
+      return statChained(path, buf);
     }
     
     ++NumStatHits;
@@ -1350,10 +1355,10 @@ PCHReader::ReadPCHBlock() {
       break;
 
     case pch::STAT_CACHE:
-      FileMgr.setStatCache(
-                  new PCHStatCache((const unsigned char *)BlobStart + Record[0],
+      StatCache = new PCHStatCache((const unsigned char *)BlobStart + Record[0],
                                    (const unsigned char *)BlobStart,
-                                   NumStatHits, NumStatMisses));
+                                   NumStatHits, NumStatMisses);
+      FileMgr.addStatCache(StatCache);
       break;
 
     case pch::EXT_VECTOR_DECLS:
@@ -1441,7 +1446,8 @@ PCHReader::PCHReadResult PCHReader::ReadPCH(const std::string &FileName) {
         SourceMgr.ClearPreallocatedSLocEntries();
 
         // Remove the stat cache.
-        FileMgr.setStatCache(0);
+        FileMgr.removeStatCache(StatCache);
+        StatCache = 0;
 
         return IgnorePCH;
       }
@@ -2011,8 +2017,14 @@ QualType PCHReader::GetType(pch::TypeID ID) {
 
   Index -= pch::NUM_PREDEF_TYPE_IDS;
   //assert(Index < TypesLoaded.size() && "Type index out-of-range");
-  if (!TypesLoaded[Index])
-    TypesLoaded[Index] = ReadTypeRecord(TypeOffsets[Index]).getTypePtr();
+  if (!TypesLoaded[Index]) {
+    Type *T = ReadTypeRecord(TypeOffsets[Index]).getTypePtr();
+    // Reading the type may already have loaded it recursively, e.g., when a
+    // record type reads its declaration, which refers back to the type.
+    if (!TypesLoaded[Index])
+      ++NumTypesRead;
+    TypesLoaded[Index] = T;
+  }
     
   return QualType(TypesLoaded[Index], Quals);
 }
@@ -2133,12 +2145,6 @@ void PCHReader::StartTranslationUnit(ASTConsumer *Consumer) {
 void PCHReader::PrintStats() {
   std::fprintf(stderr, "*** PCH Statistics:\n");
 
-  unsigned NumTypesLoaded 
-    = TypesLoaded.size() - std::count(TypesLoaded.begin(), TypesLoaded.end(),
-                                      (Type *)0);
-  unsigned NumDeclsLoaded
-    = DeclsLoaded.size() - std::count(DeclsLoaded.begin(), DeclsLoaded.end(),
-                                      (Decl *)0);
   unsigned NumIdentifiersLoaded
     = IdentifiersLoaded.size() - std::count(IdentifiersLoaded.begin(),
                                             IdentifiersLoaded.end(),
@@ -2156,12 +2162,15 @@ void PCHReader::PrintStats() {
                  ((float)NumSLocEntriesRead/TotalNumSLocEntries * 100));
   if (!TypesLoaded.empty())
     std::fprintf(stderr, "  %u/%u types read (%f%%)\n",
-                 NumTypesLoaded, (unsigned)TypesLoaded.size(),
-                 ((float)NumTypesLoaded/TypesLoaded.size() * 100));
+                 NumTypesRead, (unsigned)TypesLoaded.size(),
+                 ((float)NumTypesRead/TypesLoaded.size() * 100));
   if (!DeclsLoaded.empty())
     std::fprintf(stderr, "  %u/%u declarations read (%f%%)\n",
-                 NumDeclsLoaded, (unsigned)DeclsLoaded.size(),
-                 ((float)NumDeclsLoaded/DeclsLoaded.size() * 100));
+                 NumDeclsRead, (unsigned)DeclsLoaded.size(),
+                 ((float)NumDeclsRead/DeclsLoaded.size() * 100));
+  if (SemaObj)
+    std::fprintf(stderr, "  %u types and %u declarations read before parsing\n",
+                 NumTypesReadAtInit, NumDeclsReadAtInit);
   if (!IdentifiersLoaded.empty())
     std::fprintf(stderr, "  %u/%u identifiers read (%f%%)\n",
                  NumIdentifiersLoaded, (unsigned)IdentifiersLoaded.size(),
@@ -2226,11 +2235,17 @@ void PCHReader::InitializeSema(Sema &S) {
     SemaObj->LocallyScopedExternalDecls[D->getDeclName()] = D;
   }
 
-  // If there were any ext_vector type declarations, deserialize them
-  // and add them to Sema's vector of such declarations.
+  // Everything else (including the ext_vector type declarations, see
+  // ReadExtVectorDecls) is de-serialized on demand. Note how much has
+  // been read so far, for PrintStats.
+  NumTypesReadAtInit = NumTypesRead;
+  NumDeclsReadAtInit = NumDeclsRead;
+}
+
+void
+PCHReader::ReadExtVectorDecls(llvm::SmallVectorImpl<TypedefDecl *> &Decls) {
   for (unsigned I = 0, N = ExtVectorDecls.size(); I != N; ++I)
-    SemaObj->ExtVectorDecls.push_back(
-                               cast<TypedefDecl>(GetDecl(ExtVectorDecls[I])));
+    Decls.push_back(cast<TypedefDecl>(GetDecl(ExtVectorDecls[I])));
 }
 
 IdentifierInfo* PCHReader::get(const char *NameStart, const char *NameEnd) {
@@ -631,6 +631,7 @@ Attr *PCHReader::ReadAttributes() {
 inline void PCHReader::LoadedDecl(unsigned Index, Decl *D) {
   assert(!DeclsLoaded[Index] && "Decl loaded twice?");
   DeclsLoaded[Index] = D;
+  ++NumDeclsRead;
 }
 
 
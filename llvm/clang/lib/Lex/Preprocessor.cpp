@@ -54,6 +54,7 @@ Preprocessor::Preprocessor(Diagnostic &diags, const LangOptions &opts,
     BuiltinInfo(Target), CurPPLexer(0), CurDirLookup(0), Callbacks(0) {
   ScratchBuf = new ScratchBuffer(SourceMgr);
   CounterValue = 0; // __COUNTER__ starts at 0.
+  PTHStatCache = 0;
       
   // Clear stats.
   NumDirectives = NumDefined = NumUndefined = NumPragma = 0;
@@ -118,11 +119,16 @@ Preprocessor::~Preprocessor() {
   delete ScratchBuf;
 
   delete Callbacks;
+
+  // The PTH stat cache reads from the PTH file, which is about to go away.
+  FileMgr.removeStatCache(PTHStatCache);
 }
 
 void Preprocessor::setPTHManager(PTHManager* pm) {
+  FileMgr.removeStatCache(PTHStatCache);
   PTH.reset(pm);
-  FileMgr.setStatCache(PTH->createStatCache());
+  PTHStatCache = PTH->createStatCache();
+  FileMgr.addStatCache(PTHStatCache);
 }
 
 void Preprocessor::DumpToken(const Token &Tok, bool DumpFlags) const {
@@ -186,6 +186,7 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
   
   StdNamespace = 0;
   TUScope = 0;
+  LoadedExternalExtVectorDecls = false;
   if (getLangOptions().CPlusPlus)
     FieldCollector.reset(new CXXFieldCollector());
       
@@ -220,6 +220,10 @@ public:
   /// us to associate a raw vector type with one of the ext_vector type names.
   /// This is only necessary for issuing pretty diagnostics.
   llvm::SmallVector<TypedefDecl*, 24> ExtVectorDecls;
+
+  /// \brief Whether the ext_vector type declarations of the external source
+  /// have been loaded into ExtVectorDecls yet.
+  bool LoadedExternalExtVectorDecls;
   
   /// FieldCollector - Collects CXXFieldDecls during parsing of C++ classes.
   llvm::OwningPtr<CXXFieldCollector> FieldCollector;
@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Sema.h"
+#include "clang/Sema/ExternalSemaSource.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/ExprCXX.h"
@@ -1882,6 +1883,15 @@ CheckExtVectorComponent(QualType baseType, SourceLocation OpLoc,
   QualType VT = Context.getExtVectorType(vecType->getElementType(), CompSize);
   // Now look up the TypeDefDecl from the vector type. Without this,
   // diagostics look bad. We want extended vector types to appear built-in.
+  if (ExternalSource && !LoadedExternalExtVectorDecls) {
+    // The external source's declarations come first, as if they had been
+    // parsed before anything in this translation unit.
+    llvm::SmallVector<TypedefDecl *, 4> ExternalDecls;
+    ExternalSource->ReadExtVectorDecls(ExternalDecls);
+    ExtVectorDecls.insert(ExtVectorDecls.begin(), ExternalDecls.begin(),
+                          ExternalDecls.end());
+    LoadedExternalExtVectorDecls = true;
+  }
   for (unsigned i = 0, E = ExtVectorDecls.size(); i != E; ++i) {
     if (ExtVectorDecls[i]->getUnderlyingType() == VT)
       return Context.getTypedefType(ExtVectorDecls[i]);
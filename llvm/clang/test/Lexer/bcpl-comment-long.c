@@ -0,0 +1,16 @@
+// RUN: clang-cc -E %s | grep foo &&
+// RUN: clang-cc -E %s | not grep bar &&
+// RUN: clang-cc -E %s | grep baz &&
+// RUN: clang-cc -E -trigraphs %s | not grep baz &&
+// RUN: clang-cc -E %s | grep qux
+
+// The comments below are long enough to be skipped in chunks; make sure the
+// characters that need a closer look are still found wherever they fall.
+
+// A long comment ending with an escaped newline, which continues it. \
+int bar;
+int foo;
+// A long comment ending with a trigraph for an escaped newline. ??/
+int baz;
+//                                                                 ??? \\ ?
+int qux;
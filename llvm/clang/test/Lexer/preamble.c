@@ -0,0 +1,31 @@
+// Preamble detection test: see below for comments and test commands.
+#include "foo"
+#if FOO
+#else
+#  define BAR 1
+#endif
+#include "bar"
+#ifndef QUX
+#  define QUX 2
+#endif
+#pragma once
+/* A block comment. */
+int foo();
+#include "baz"
+
+// RUN: clang-cc -print-preamble %s > %t &&
+// RUN: FileCheck %s < %t &&
+// RUN: not grep 'int foo' %t
+
+// CHECK: // Preamble detection test: see below for comments and test commands.
+// CHECK-NEXT: #include "foo"
+// CHECK-NEXT: #if FOO
+// CHECK-NEXT: #else
+// CHECK-NEXT: #  define BAR 1
+// CHECK-NEXT: #endif
+// CHECK-NEXT: #include "bar"
+// CHECK-NEXT: #ifndef QUX
+// CHECK-NEXT: #  define QUX 2
+// CHECK-NEXT: #endif
+// CHECK-NEXT: #pragma once
+// CHECK-NEXT: /* A block comment. */
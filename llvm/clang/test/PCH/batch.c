@@ -0,0 +1,12 @@
+// Each input in a batch gets its own PCH or PTH reader, but all of them share
+// one FileManager, so stat caches from an earlier input must not linger.
+
+// Test with pch.
+// RUN: clang-cc -emit-pch -o %t.pch %S/batch.h &&
+// RUN: clang-cc -include-pch %t.pch -fsyntax-only %s %s &&
+
+// Test with pth.
+// RUN: clang-cc -emit-pth -o %t.pth %S/batch.h &&
+// RUN: clang-cc -include-pth %t.pth -fsyntax-only %s %s
+
+batch_int x;
@@ -0,0 +1,3 @@
+// Helper header for batch.c PCH and PTH test
+
+typedef int batch_int;
@@ -0,0 +1,6 @@
+// RUN: echo %s %s > %t.rsp &&
+// RUN: clang-cc -E @%t.rsp | grep IMPORTED_BODY | count 2
+
+// Each input file in a batch starts with a clean slate of included headers,
+// so the #import below must take effect in both translation units.
+#import "batch-inputs.h"
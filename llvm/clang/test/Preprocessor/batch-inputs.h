@@ -0,0 +1 @@
+IMPORTED_BODY
@@ -143,6 +143,7 @@ enum ProgActions {
   PrintPreprocessedInput,       // -E mode.
   DumpTokens,                   // Dump out preprocessed tokens.
   DumpRawTokens,                // Dump out raw tokens.
+  PrintPreamble,                // Print the preamble of the input file.
   RunAnalysis,                  // Run one or more source code analyses. 
   GeneratePTH,                  // Generate pre-tokenized header.
   GeneratePCH,                  // Generate pre-compiled header.
@@ -159,6 +160,8 @@ ProgAction(llvm::cl::desc("Choose output type:"), llvm::cl::ZeroOrMore,
                         "Run preprocessor, emit preprocessed file"),
              clEnumValN(DumpRawTokens, "dump-raw-tokens",
                         "Lex file in raw mode and dump raw tokens"),
+             clEnumValN(PrintPreamble, "print-preamble",
+                        "Print the preamble (leading directives) of the file"),
              clEnumValN(RunAnalysis, "analyze",
                         "Run static analysis engine"),
              clEnumValN(DumpTokens, "dump-tokens",
@@ -1887,6 +1890,18 @@ static void ProcessInputFile(Preprocessor &PP, PreprocessorFactory &PPF,
     ClearSourceMgr = true;
     break;
   }
+  case PrintPreamble: {
+    llvm::TimeRegion Timer(ClangFrontendTimer);
+    SourceManager &SM = PP.getSourceManager();
+    std::pair<const char*, const char*> Buffer =
+      SM.getBufferData(SM.getMainFileID());
+    unsigned PreambleSize = Lexer::ComputePreamble(Buffer.first, Buffer.second,
+                                                   PP.getLangOptions());
+    OS.reset(ComputeOutFile(InFile, 0, true, OutPath));
+    OS->write(Buffer.first, PreambleSize);
+    ClearSourceMgr = true;
+    break;
+  }
   case DumpTokens: {                 // Token dump mode.
     llvm::TimeRegion Timer(ClangFrontendTimer);
     Token Tok;
@@ -2151,8 +2166,10 @@ int main(int argc, char **argv) {
   llvm::sys::PrintStackTraceOnErrorSignal();
   llvm::PrettyStackTraceProgram X(argc, argv);
   llvm::LLVMContext &Context = llvm::getGlobalContext();
+  // Allow large batches of input files to be passed in @file response files.
   llvm::cl::ParseCommandLineOptions(argc, argv,
-                              "LLVM 'Clang' Compiler: http://clang.llvm.org\n");
+                              "LLVM 'Clang' Compiler: http://clang.llvm.org\n",
+                              /*ReadResponseFiles=*/true);
   
   llvm::InitializeAllTargets();
   llvm::InitializeAllAsmPrinters();
@@ -2261,6 +2278,11 @@ int main(int argc, char **argv) {
   llvm::StringMap<bool> Features;
   ComputeFeatureMap(Target.get(), Features);
 
+  // The header search paths only depend on the language, so consecutive input
+  // files of the same language share a HeaderSearch and its lookup caches.
+  llvm::OwningPtr<HeaderSearch> HeaderInfo;
+  bool HeaderInfoCPlusPlus = false, HeaderInfoObjC = false;
+
   for (unsigned i = 0, e = InputFilenames.size(); i != e; ++i) {
     const std::string &InFile = InputFilenames[i];
     
@@ -2281,14 +2303,20 @@ int main(int argc, char **argv) {
     InitializeLanguageStandard(LangInfo, LK, Target.get(), Features);
           
     // Process the -I options and set them in the HeaderInfo.
-    HeaderSearch HeaderInfo(FileMgr);
-    
-    
-    InitializeIncludePaths(argv[0], HeaderInfo, FileMgr, LangInfo);
+    if (!HeaderInfo || HeaderInfoCPlusPlus != LangInfo.CPlusPlus ||
+        HeaderInfoObjC != LangInfo.ObjC1) {
+      HeaderInfo.reset(new HeaderSearch(FileMgr));
+      InitializeIncludePaths(argv[0], *HeaderInfo, FileMgr, LangInfo);
+      HeaderInfoCPlusPlus = LangInfo.CPlusPlus;
+      HeaderInfoObjC = LangInfo.ObjC1;
+    } else {
+      // Forget which headers the previous input file included.
+      HeaderInfo->ClearFileInfo();
+    }
     
     // Set up the preprocessor with these options.
     DriverPreprocessorFactory PPFactory(Diags, LangInfo, *Target,
-                                        *SourceMgr.get(), HeaderInfo);
+                                        *SourceMgr.get(), *HeaderInfo);
     
     llvm::OwningPtr<Preprocessor> PP(PPFactory.CreatePreprocessor());
           
@@ -2335,7 +2363,6 @@ int main(int argc, char **argv) {
     // Process the source file.
     ProcessInputFile(*PP, PPFactory, InFile, ProgAction, Features, Context);
     
-    HeaderInfo.ClearFileInfo();
     DiagClient->setLangOptions(0);
   }
 
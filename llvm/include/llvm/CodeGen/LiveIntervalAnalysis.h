@@ -69,6 +69,10 @@ namespace llvm {
     ///
     BumpPtrAllocator VNInfoAllocator;
 
+    /// Special pool allocator for the LiveInterval objects in r2iMap_.
+    ///
+    BumpPtrAllocator IntervalAllocator;
+
     /// MBB2IdxMap - The indexes of the first and last instructions in the
     /// specified basic block.
     std::vector<std::pair<unsigned, unsigned> > MBB2IdxMap;
@@ -281,7 +285,7 @@ namespace llvm {
     LiveInterval &getOrCreateInterval(unsigned reg) {
       Reg2IntervalMap::iterator I = r2iMap_.find(reg);
       if (I == r2iMap_.end())
-        I = r2iMap_.insert(std::make_pair(reg, createInterval(reg))).first;
+        I = r2iMap_.insert(std::make_pair(reg, allocateInterval(reg))).first;
       return *I->second;
     }
 
@@ -298,7 +302,7 @@ namespace llvm {
 
     void removeInterval(unsigned Reg) {
       DenseMap<unsigned, LiveInterval*>::iterator I = r2iMap_.find(Reg);
-      delete I->second;
+      I->second->~LiveInterval();
       r2iMap_.erase(I);
     }
 
@@ -536,6 +540,10 @@ namespace llvm {
 
     static LiveInterval* createInterval(unsigned Reg);
 
+    /// allocateInterval - Create a new live interval for Reg in
+    /// IntervalAllocator.  Its memory is reclaimed by releaseMemory.
+    LiveInterval* allocateInterval(unsigned Reg);
+
     void printRegName(unsigned reg) const;
   };
 
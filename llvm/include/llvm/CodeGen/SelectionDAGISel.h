@@ -65,6 +65,10 @@ public:
 
   virtual bool runOnMachineFunction(MachineFunction &MF);
 
+  /// doFinalization - Print the per-opcode counts of instructions FastISel
+  /// failed to select, if -fast-isel-stats was given.
+  virtual bool doFinalization(Module &M);
+
   unsigned MakeReg(EVT VT);
 
   virtual void EmitFunctionEntryCode(Function &Fn, MachineFunction &MF) {}
@@ -129,6 +133,14 @@ private:
 
   bool HandlePHINodesInSuccessorBlocksFast(BasicBlock *LLVMBB, FastISel *F);
 
+  /// CountFastISelMiss - Record that FastISel handed the specified
+  /// instruction over to SelectionDAG.
+  void CountFastISelMiss(const Instruction *I);
+
+  /// FastISelMisses - The number of instructions of each opcode that FastISel
+  /// failed to select, indexed by opcode. Only kept with -fast-isel-stats.
+  std::vector<unsigned> FastISelMisses;
+
   /// Create the scheduler. If a specific scheduler was specified
   /// via the SchedulerRegistry, use it, otherwise select the
   /// one preferred by the target.
@@ -157,6 +157,11 @@ public:
   // dumpPassStructure - Implement the -debug-passes=PassStructure option
   virtual void dumpPassStructure(unsigned Offset = 0);
 
+  /// getAsImmutablePass - Return this pass as an ImmutablePass, or null if it
+  /// is not one.  The pass manager asks this for every available analysis
+  /// after every pass runs, so avoid paying for a dynamic_cast there.
+  virtual ImmutablePass *getAsImmutablePass() { return 0; }
+
   template<typename AnalysisClass>
   static const PassInfo *getClassPassInfo() {
     return lookupPassInfo(intptr_t(&AnalysisClass::ID));
@@ -251,6 +256,8 @@ public:
   ///
   bool runOnModule(Module &) { return false; }
 
+  virtual ImmutablePass *getAsImmutablePass() { return this; }
+
   explicit ImmutablePass(intptr_t pid) : ModulePass(pid) {}
   explicit ImmutablePass(const void *pid) 
   : ModulePass(pid) {}
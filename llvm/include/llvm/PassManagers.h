@@ -251,6 +251,11 @@ private:
   // LastUser map.
   DenseMap<Pass *, SmallPtrSet<Pass *, 8> > InversedLastUser;
 
+  // True if LastUser has changed since InversedLastUser was last computed.
+  // FunctionPassManager::run is invoked once per function, so avoid
+  // rebuilding the inverse map when the pass schedule has not changed.
+  bool InversedLastUserIsStale;
+
   /// Immutable passes are managed by top level manager.
   SmallVector<ImmutablePass *, 8> ImmutablePasses;
 
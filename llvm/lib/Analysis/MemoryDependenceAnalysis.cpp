@@ -22,6 +22,7 @@
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/PredIteratorCache.h"
 #include "llvm/Support/Debug.h"
 using namespace llvm;
@@ -38,6 +39,17 @@ STATISTIC(NumUncacheNonLocalPtr,
           "Number of uncached non-local ptr responses");
 STATISTIC(NumCacheCompleteNonLocalPtr,
           "Number of block queries that were completely cached");
+STATISTIC(NumNonLocalPtrLimited,
+          "Number of non-local ptr queries cut off by the block limit");
+
+// NonLocalBlockLimit - Queries that reach more than this many blocks are
+// answered with a conservative clobber instead.  This bounds the CFG walk and
+// the cached results on very large functions.
+static cl::opt<unsigned>
+NonLocalBlockLimit("memdep-nonlocal-block-limit", cl::Hidden,
+                   cl::init(1000),
+                   cl::desc("Maximum number of blocks to visit for one "
+                            "non-local pointer dependence query"));
 
 char MemoryDependenceAnalysis::ID = 0;
   
@@ -712,6 +724,25 @@ getNonLocalPointerDepFromBB(Value *Pointer, uint64_t PointeeSize,
   while (!Worklist.empty()) {
     BasicBlock *BB = Worklist.pop_back_val();
     
+    // If this query has already reached a very large number of blocks, it is
+    // getting expensive and the result is unlikely to be useful.  Give up and
+    // report a clobber.  Visited is shared with the phi translated subqueries,
+    // so this bounds the whole walk, including transparent blocks.
+    if (Visited.size() > NonLocalBlockLimit) {
+      ++NumNonLocalPtrLimited;
+
+      // Make sure the cache is sorted before anything else looks at it.
+      if (NumSortedEntries != Cache->size())
+        SortNonLocalDepInfoCache(*Cache, NumSortedEntries);
+
+      // Since we bail out, the "Cache" set won't contain all of the results
+      // for the query.  This is ok (we can still use it to accelerate
+      // specific block queries) but we can't do the fastpath "return all
+      // results from the set".  Clear out the indicator for this.
+      CacheInfo->first = BBSkipFirstBlockPair();
+      return true;
+    }
+
     // Skip the first block if we have it.
     if (!SkipFirstBlock) {
       // Analyze the dependency of *Pointer in FromBB.  See if we already have
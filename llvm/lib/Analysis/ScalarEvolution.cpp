@@ -94,6 +94,8 @@ STATISTIC(NumTripCountsNotComputed,
           "Number of loops without predictable loop counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumTripCountCacheHits,
+          "Number of trip count queries answered from the cache");
 
 static cl::opt<unsigned>
 MaxBruteForceIterations("scalar-evolution-max-iterations", cl::ReallyHidden,
@@ -3244,7 +3246,8 @@ ScalarEvolution::getBackedgeTakenInfo(const Loop *L) {
         PushDefUseChildren(I, Worklist);
       }
     }
-  }
+  } else
+    ++NumTripCountCacheHits;
   return Pair.first->second;
 }
 
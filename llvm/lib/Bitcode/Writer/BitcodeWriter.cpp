@@ -1137,11 +1137,12 @@ static void WriteFunction(const Function &F, ValueEnumerator &VE,
   unsigned InstID = CstEnd;
   
   // Finally, emit all the instructions, in order.
+  const Type *VoidTy = Type::getVoidTy(F.getContext());
   for (Function::const_iterator BB = F.begin(), E = F.end(); BB != E; ++BB)
     for (BasicBlock::const_iterator I = BB->begin(), E = BB->end();
          I != E; ++I) {
       WriteInstruction(*I, InstID, VE, Stream, Vals);
-      if (I->getType() != Type::getVoidTy(F.getContext()))
+      if (I->getType() != VoidTy)
         ++InstID;
     }
   
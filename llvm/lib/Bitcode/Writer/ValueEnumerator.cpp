@@ -357,9 +357,10 @@ void ValueEnumerator::incorporateFunction(const Function &F) {
   FirstInstID = Values.size();
   
   // Add all of the instructions.
+  const Type *VoidTy = Type::getVoidTy(F.getContext());
   for (Function::const_iterator BB = F.begin(), E = F.end(); BB != E; ++BB) {
     for (BasicBlock::const_iterator I = BB->begin(), E = BB->end(); I!=E; ++I) {
-      if (I->getType() != Type::getVoidTy(F.getContext()))
+      if (I->getType() != VoidTy)
         EnumerateValue(I);
     }
   }
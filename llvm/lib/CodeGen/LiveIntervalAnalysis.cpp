@@ -88,7 +88,7 @@ void LiveIntervals::releaseMemory() {
   // Free the live intervals themselves.
   for (DenseMap<unsigned, LiveInterval*>::iterator I = r2iMap_.begin(),
        E = r2iMap_.end(); I != E; ++I)
-    delete I->second;
+    I->second->~LiveInterval();
   
   MBB2IdxMap.clear();
   Idx2MBBMap.clear();
@@ -99,6 +99,7 @@ void LiveIntervals::releaseMemory() {
 
   // Release VNInfo memroy regions after all VNInfo objects are dtor'd.
   VNInfoAllocator.Reset();
+  IntervalAllocator.Reset();
   while (!ClonedMIs.empty()) {
     MachineInstr *MI = ClonedMIs.back();
     ClonedMIs.pop_back();
@@ -1113,9 +1114,21 @@ bool LiveIntervals::findReachableMBBs(unsigned Start, unsigned End,
   return ResVal;
 }
 
+/// getInitialWeight - Return the spill weight a new interval for reg starts
+/// with.  Physical registers can never be spilled.
+static float getInitialWeight(unsigned reg) {
+  return TargetRegisterInfo::isPhysicalRegister(reg) ? HUGE_VALF : 0.0F;
+}
+
 LiveInterval* LiveIntervals::createInterval(unsigned reg) {
-  float Weight = TargetRegisterInfo::isPhysicalRegister(reg) ? HUGE_VALF : 0.0F;
-  return new LiveInterval(reg, Weight);
+  return new LiveInterval(reg, getInitialWeight(reg));
+}
+
+LiveInterval* LiveIntervals::allocateInterval(unsigned reg) {
+  LiveInterval *LI =
+    static_cast<LiveInterval*>(IntervalAllocator.Allocate(sizeof(LiveInterval),
+                                                      alignOf<LiveInterval>()));
+  return new (LI) LiveInterval(reg, getInitialWeight(reg));
 }
 
 /// dupInterval - Duplicate a live interval. The caller is responsible for
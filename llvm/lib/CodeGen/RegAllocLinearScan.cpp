@@ -115,6 +115,10 @@ namespace {
     ///
     IntervalPtrs fixed_;
 
+    /// fixedIndex_ - Maps each physical register with a fixed interval to the
+    /// position of that interval in fixed_.
+    DenseMap<unsigned, unsigned> fixedIndex_;
+
     /// active_ - Intervals that are currently being processed, and which have a
     /// live range active for the current point.
     IntervalPtrs active_;
@@ -452,6 +456,7 @@ bool RALinScan::runOnMachineFunction(MachineFunction &fn) {
   finalizeRegUses();
 
   fixed_.clear();
+  fixedIndex_.clear();
   active_.clear();
   inactive_.clear();
   handled_.clear();
@@ -476,6 +481,7 @@ void RALinScan::initIntervalSets()
   for (LiveIntervals::iterator i = li_->begin(), e = li_->end(); i != e; ++i) {
     if (TargetRegisterInfo::isPhysicalRegister(i->second->reg)) {
       mri_->setPhysRegUsed(i->second->reg);
+      fixedIndex_[i->second->reg] = fixed_.size();
       fixed_.push_back(std::make_pair(i->second, i->second->begin()));
     } else
       unhandled_.push(i->second);
@@ -956,27 +962,32 @@ void RALinScan::assignRegOrStackSlotAtInterval(LiveInterval* cur)
   if (physReg) {
     // We got a register.  However, if it's in the fixed_ list, we might
     // conflict with it.  Check to see if we conflict with it or any of its
-    // aliases.
-    SmallSet<unsigned, 8> RegAliases;
+    // aliases.  Only their fixed intervals can conflict, so look those up
+    // directly rather than walking the whole fixed_ list.
+    SmallVector<unsigned, 8> RegAliases;
+    RegAliases.push_back(physReg);
     for (const unsigned *AS = tri_->getAliasSet(physReg); *AS; ++AS)
-      RegAliases.insert(*AS);
+      RegAliases.push_back(*AS);
     
     bool ConflictsWithFixed = false;
-    for (unsigned i = 0, e = fixed_.size(); i != e; ++i) {
-      IntervalPtr &IP = fixed_[i];
-      if (physReg == IP.first->reg || RegAliases.count(IP.first->reg)) {
-        // Okay, this reg is on the fixed list.  Check to see if we actually
-        // conflict.
-        LiveInterval *I = IP.first;
-        if (I->endNumber() > StartPosition) {
-          LiveInterval::iterator II = I->advanceTo(IP.second, StartPosition);
-          IP.second = II;
-          if (II != I->begin() && II->start > StartPosition)
-            --II;
-          if (cur->overlapsFrom(*I, II)) {
-            ConflictsWithFixed = true;
-            break;
-          }
+    for (unsigned i = 0, e = RegAliases.size(); i != e; ++i) {
+      DenseMap<unsigned, unsigned>::iterator FI =
+        fixedIndex_.find(RegAliases[i]);
+      if (FI == fixedIndex_.end())
+        continue;
+
+      // Okay, this reg is on the fixed list.  Check to see if we actually
+      // conflict.
+      IntervalPtr &IP = fixed_[FI->second];
+      LiveInterval *I = IP.first;
+      if (I->endNumber() > StartPosition) {
+        LiveInterval::iterator II = I->advanceTo(IP.second, StartPosition);
+        IP.second = II;
+        if (II != I->begin() && II->start > StartPosition)
+          --II;
+        if (cur->overlapsFrom(*I, II)) {
+          ConflictsWithFixed = true;
+          break;
         }
       }
     }
@@ -125,6 +125,9 @@ namespace {
     }
 
     void AddToPhysRegsUseOrder(unsigned Reg) {
+      if (!PhysRegsUseOrder.empty() && PhysRegsUseOrder.back() == Reg)
+        return;  // Already most recently used
+
       std::vector<unsigned>::iterator It =
         std::find(PhysRegsUseOrder.begin(), PhysRegsUseOrder.end(), Reg);
       if (It != PhysRegsUseOrder.end())
@@ -275,7 +278,11 @@ int RALocal::getStackSpaceFor(unsigned VirtReg, const TargetRegisterClass *RC) {
 /// longer being in use.
 ///
 void RALocal::removePhysReg(unsigned PhysReg) {
+  // Only registers that currently hold a value (pinned or virtual) are in
+  // PhysRegsUseOrder, so there is nothing to search for otherwise.
+  bool WasInUseOrder = PhysRegsUsed[PhysReg] >= 0;
   PhysRegsUsed[PhysReg] = -1;      // PhyReg no longer used
+  if (!WasInUseOrder) return;
 
   std::vector<unsigned>::iterator It =
     std::find(PhysRegsUseOrder.begin(), PhysRegsUseOrder.end(), PhysReg);
@@ -44,6 +44,7 @@ STATISTIC(NodesCombined   , "Number of dag nodes combined");
 STATISTIC(PreIndexedNodes , "Number of pre-indexed nodes created");
 STATISTIC(PostIndexedNodes, "Number of post-indexed nodes created");
 STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
+STATISTIC(NodesVisited    , "Number of dag nodes visited");
 
 namespace {
   static cl::opt<bool>
@@ -64,8 +65,11 @@ namespace {
     bool LegalOperations;
     bool LegalTypes;
 
-    // Worklist of all of the nodes that need to be simplified.
+    // Worklist of all of the nodes that need to be simplified.  Removed nodes
+    // are nulled out in place rather than erased, and WorkListMap maps each
+    // node still on the worklist to its index.
     std::vector<SDNode*> WorkList;
+    DenseMap<SDNode*, unsigned> WorkListMap;
 
     // AA - Used for DAG load/store alias analysis.
     AliasAnalysis &AA;
@@ -88,15 +92,25 @@ namespace {
     /// AddToWorkList - Add to the work list making sure it's instance is at the
     /// the back (next to be processed.)
     void AddToWorkList(SDNode *N) {
-      removeFromWorkList(N);
+      std::pair<DenseMap<SDNode*, unsigned>::iterator, bool> IP =
+        WorkListMap.insert(std::make_pair(N, (unsigned)WorkList.size()));
+      if (!IP.second) {
+        // Already on the worklist; null out the old slot and move it back.
+        WorkList[IP.first->second] = 0;
+        IP.first->second = WorkList.size();
+      }
       WorkList.push_back(N);
     }
 
     /// removeFromWorkList - remove all instances of N from the worklist.
     ///
     void removeFromWorkList(SDNode *N) {
-      WorkList.erase(std::remove(WorkList.begin(), WorkList.end(), N),
-                     WorkList.end());
+      DenseMap<SDNode*, unsigned>::iterator It = WorkListMap.find(N);
+      if (It == WorkListMap.end()) return; // Not in worklist.
+
+      // Don't bother moving everything down, just null out the slot.
+      WorkList[It->second] = 0;
+      WorkListMap.erase(It);
     }
 
     SDValue CombineTo(SDNode *N, const SDValue *To, unsigned NumTo,
@@ -634,9 +648,12 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
 
   // Add all the dag nodes to the worklist.
   WorkList.reserve(DAG.allnodes_size());
+  WorkListMap.resize(DAG.allnodes_size()*2);
   for (SelectionDAG::allnodes_iterator I = DAG.allnodes_begin(),
-       E = DAG.allnodes_end(); I != E; ++I)
+       E = DAG.allnodes_end(); I != E; ++I) {
+    WorkListMap[I] = WorkList.size();
     WorkList.push_back(I);
+  }
 
   // Create a dummy node (which is not added to allnodes), that adds a reference
   // to the root node, preventing it from being deleted, and tracking any
@@ -652,6 +669,9 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   while (!WorkList.empty()) {
     SDNode *N = WorkList.back();
     WorkList.pop_back();
+    if (N == 0) continue;  // skip removed entries.
+    WorkListMap.erase(N);
+    ++NodesVisited;
 
     // If N has no uses, it is dead.  Make sure to revisit all N's operands once
     // N is deleted from the DAG, since they too may now be dead or may have a
@@ -46,6 +46,7 @@
 #include "llvm/Target/TargetLowering.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -55,6 +56,8 @@
 #include <algorithm>
 using namespace llvm;
 
+STATISTIC(NumFastIselFailures, "Number of instructions fast isel failed on");
+
 static cl::opt<bool>
 DisableLegalizeTypes("disable-legalize-types", cl::Hidden);
 static cl::opt<bool>
@@ -65,6 +68,10 @@ static cl::opt<bool>
 EnableFastISelAbort("fast-isel-abort", cl::Hidden,
           cl::desc("Enable abort calls when \"fast\" instruction fails"));
 static cl::opt<bool>
+EnableFastISelStats("fast-isel-stats", cl::Hidden,
+          cl::desc("Print per-opcode counts of instructions the \"fast\" "
+                   "instruction selector failed on"));
+static cl::opt<bool>
 SchedLiveInCopies("schedule-livein-copies",
                   cl::desc("Schedule copies of livein registers"),
                   cl::init(false));
@@ -283,6 +290,27 @@ SelectionDAGISel::~SelectionDAGISel() {
   delete FuncInfo;
 }
 
+bool SelectionDAGISel::doFinalization(Module &M) {
+  if (!FastISelMisses.empty()) {
+    errs() << "FastISel misses by opcode:\n";
+    for (unsigned i = 0, e = FastISelMisses.size(); i != e; ++i)
+      if (FastISelMisses[i])
+        errs() << "  " << Instruction::getOpcodeName(i) << ": "
+               << FastISelMisses[i] << "\n";
+    FastISelMisses.clear();
+  }
+  return false;
+}
+
+void SelectionDAGISel::CountFastISelMiss(const Instruction *I) {
+  ++NumFastIselFailures;
+  if (!EnableFastISelStats)
+    return;
+  if (FastISelMisses.empty())
+    FastISelMisses.resize(Instruction::OtherOpsEnd);
+  ++FastISelMisses[I->getOpcode()];
+}
+
 unsigned SelectionDAGISel::MakeReg(EVT VT) {
   return RegInfo->createVirtualRegister(TLI.getRegClassFor(VT));
 }
@@ -726,6 +754,7 @@ void SelectionDAGISel::SelectAllBasicBlocks(Function &Fn,
         // feed PHI nodes in successor blocks.
         if (isa<TerminatorInst>(BI))
           if (!HandlePHINodesInSuccessorBlocksFast(LLVMBB, FastIS)) {
+            CountFastISelMiss(BI);
             if (EnableFastISelVerbose || EnableFastISelAbort) {
               cerr << "FastISel miss: ";
               BI->dump();
@@ -745,6 +774,7 @@ void SelectionDAGISel::SelectAllBasicBlocks(Function &Fn,
 
         // Then handle certain instructions as single-LLVM-Instruction blocks.
         if (isa<CallInst>(BI)) {
+          CountFastISelMiss(BI);
           if (EnableFastISelVerbose || EnableFastISelAbort) {
             cerr << "FastISel missed call: ";
             BI->dump();
@@ -765,6 +795,7 @@ void SelectionDAGISel::SelectAllBasicBlocks(Function &Fn,
         }
 
         // Otherwise, give up on FastISel for the rest of the block.
+        CountFastISelMiss(BI);
         // For now, be a little lenient about non-branch terminators.
         if (!isa<TerminatorInst>(BI) || isa<BranchInst>(BI)) {
           if (EnableFastISelVerbose || EnableFastISelAbort) {
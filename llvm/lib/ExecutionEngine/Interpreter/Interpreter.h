@@ -20,6 +20,7 @@
 #include "llvm/Support/InstVisitor.h"
 #include "llvm/Support/CallSite.h"
 #include "llvm/Target/TargetData.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/DataTypes.h"
 #include "llvm/Support/ErrorHandling.h"
 
@@ -64,6 +65,12 @@ public:
 
 typedef std::vector<GenericValue> ValuePlaneTy;
 
+/// GenericValueDenseMapInfo - Traits to tell DenseMap that GenericValue is not
+/// a POD (its APInt member needs its destructor called).
+struct GenericValueDenseMapInfo {
+  static bool isPod() { return false; }
+};
+
 // ExecutionContext struct - This struct represents one stack frame currently
 // executing.
 //
@@ -71,7 +78,9 @@ struct ExecutionContext {
   Function             *CurFunction;// The currently executing function
   BasicBlock           *CurBB;      // The currently executing BB
   BasicBlock::iterator  CurInst;    // The next instruction to execute
-  std::map<Value *, GenericValue> Values; // LLVM values used in this invocation
+  // LLVM values used in this invocation
+  DenseMap<Value *, GenericValue, DenseMapInfo<Value *>,
+           GenericValueDenseMapInfo> Values;
   std::vector<GenericValue>  VarArgs; // Values passed through an ellipsis
   CallSite             Caller;     // Holds the call that called subframes.
                                    // NULL if main func or debugger invoked fn
@@ -180,9 +180,13 @@ JITResolver *JITResolver::TheJITResolver = 0;
 void *JITResolver::getFunctionStubIfAvailable(Function *F) {
   MutexGuard locked(TheJIT->lock);
 
-  // If we already have a stub for this function, recycle it.
-  void *&Stub = state.getFunctionToStubMap(locked)[F];
-  return Stub;
+  // If we already have a stub for this function, recycle it.  Don't use
+  // operator[] here: that would leave a null entry (and a value handle on F)
+  // behind for every function referenced before its stub is created.
+  FunctionToStubMapTy::iterator I = state.getFunctionToStubMap(locked).find(F);
+  if (I == state.getFunctionToStubMap(locked).end())
+    return 0;
+  return I->second;
 }
 
 /// getFunctionStub - This returns a pointer to a function stub, creating
@@ -257,23 +257,39 @@ public:
 }
 
 MemoryBuffer *MemoryBuffer::getSTDIN() {
-  char Buffer[4096*4];
-
-  std::vector<char> FileData;
-
-  // Read in all of the data from stdin, we cannot mmap stdin.
+  // Read in all of the data from stdin, we cannot mmap stdin.  Read directly
+  // into a malloc'd buffer that we grow geometrically, and hand that buffer
+  // to the MemoryBuffer, so that the data is not copied again after reading.
   sys::Program::ChangeStdinToBinary();
+  size_t Capacity = 4096*4;
+  size_t Size = 0;
+  char *Buf = (char *)malloc(Capacity + 1);
+  if (!Buf) return 0;
+
   size_t ReadBytes;
   do {
-    ReadBytes = fread(Buffer, sizeof(char), sizeof(Buffer), stdin);
-    FileData.insert(FileData.end(), Buffer, Buffer+ReadBytes);
-  } while (ReadBytes == sizeof(Buffer));
+    if (Size == Capacity) {
+      Capacity *= 2;
+      char *NewBuf = (char *)realloc(Buf, Capacity + 1);
+      if (!NewBuf) {
+        free(Buf);
+        return 0;
+      }
+      Buf = NewBuf;
+    }
+    ReadBytes = fread(Buf + Size, sizeof(char), Capacity - Size, stdin);
+    Size += ReadBytes;
+  } while (Size == Capacity);
 
-  FileData.push_back(0); // &FileData[Size] is invalid. So is &*FileData.end().
-  size_t Size = FileData.size();
-  if (Size <= 1)
+  if (Size == 0) {
+    free(Buf);
     return 0;
+  }
+
+  Buf[Size] = 0;  // Null terminate buffer.
   MemoryBuffer *B = new STDINBufferFile();
-  B->initCopyOf(&FileData[0], &FileData[Size-1]);
+  B->init(Buf, Buf+Size);
+  // The memory for this buffer is owned by the MemoryBuffer.
+  B->MustDeleteBuffer = true;
   return B;
 }
@@ -81,12 +81,13 @@ public:
 private:
   bool X86FastEmitCompare(Value *LHS, Value *RHS, EVT VT);
   
-  bool X86FastEmitLoad(EVT VT, const X86AddressMode &AM, unsigned &RR);
+  bool X86FastEmitLoad(EVT VT, const X86AddressMode &AM, unsigned &RR,
+                       unsigned Alignment = 0);
 
   bool X86FastEmitStore(EVT VT, Value *Val,
-                        const X86AddressMode &AM);
+                        const X86AddressMode &AM, unsigned Alignment = 0);
   bool X86FastEmitStore(EVT VT, unsigned Val,
-                        const X86AddressMode &AM);
+                        const X86AddressMode &AM, unsigned Alignment = 0);
 
   bool X86FastEmitExtend(ISD::NodeType Opc, EVT DstVT, unsigned Src, EVT SrcVT,
                          unsigned &ResultReg);
@@ -118,6 +119,11 @@ private:
   bool X86VisitIntrinsicCall(IntrinsicInst &I);
   bool X86SelectCall(Instruction *I);
 
+  bool IsMemcpySmall(uint64_t Len);
+
+  bool TryEmitSmallMemcpy(X86AddressMode DestAM,
+                          X86AddressMode SrcAM, uint64_t Len);
+
   CCAssignFn *CCAssignFnForCall(unsigned CC, bool isTailCall = false);
 
   const X86InstrInfo *getInstrInfo() const {
@@ -187,9 +193,10 @@ CCAssignFn *X86FastISel::CCAssignFnForCall(unsigned CC, bool isTaillCall) {
 
 /// X86FastEmitLoad - Emit a machine instruction to load a value of type VT.
 /// The address is either pre-computed, i.e. Ptr, or a GlobalAddress, i.e. GV.
+/// Vector loads use the aligned forms only if Alignment is at least 16.
 /// Return true and the result register by reference if it is possible.
 bool X86FastISel::X86FastEmitLoad(EVT VT, const X86AddressMode &AM,
-                                  unsigned &ResultReg) {
+                                  unsigned &ResultReg, unsigned Alignment) {
   // Get opcode and regclass of the output for the given load instruction.
   unsigned Opc = 0;
   const TargetRegisterClass *RC = NULL;
@@ -233,6 +240,21 @@ bool X86FastISel::X86FastEmitLoad(EVT VT, const X86AddressMode &AM,
   case MVT::f80:
     // No f80 support yet.
     return false;
+  case MVT::v4f32:
+    Opc = Alignment >= 16 ? X86::MOVAPSrm : X86::MOVUPSrm;
+    RC  = X86::VR128RegisterClass;
+    break;
+  case MVT::v2f64:
+    Opc = Alignment >= 16 ? X86::MOVAPDrm : X86::MOVUPDrm;
+    RC  = X86::VR128RegisterClass;
+    break;
+  case MVT::v16i8:
+  case MVT::v8i16:
+  case MVT::v4i32:
+  case MVT::v2i64:
+    Opc = Alignment >= 16 ? X86::MOVDQArm : X86::MOVDQUrm;
+    RC  = X86::VR128RegisterClass;
+    break;
   }
 
   ResultReg = createResultReg(RC);
@@ -246,7 +268,7 @@ bool X86FastISel::X86FastEmitLoad(EVT VT, const X86AddressMode &AM,
 /// i.e. V. Return true if it is possible.
 bool
 X86FastISel::X86FastEmitStore(EVT VT, unsigned Val,
-                              const X86AddressMode &AM) {
+                              const X86AddressMode &AM, unsigned Alignment) {
   // Get opcode and regclass of the output for the given store instruction.
   unsigned Opc = 0;
   switch (VT.getSimpleVT().SimpleTy) {
@@ -262,6 +284,18 @@ X86FastISel::X86FastEmitStore(EVT VT, unsigned Val,
   case MVT::f64:
     Opc = Subtarget->hasSSE2() ? X86::MOVSDmr : X86::ST_Fp64m;
     break;
+  case MVT::v4f32:
+    Opc = Alignment >= 16 ? X86::MOVAPSmr : X86::MOVUPSmr;
+    break;
+  case MVT::v2f64:
+    Opc = Alignment >= 16 ? X86::MOVAPDmr : X86::MOVUPDmr;
+    break;
+  case MVT::v16i8:
+  case MVT::v8i16:
+  case MVT::v4i32:
+  case MVT::v2i64:
+    Opc = Alignment >= 16 ? X86::MOVDQAmr : X86::MOVDQUmr;
+    break;
   }
   
   addFullAddress(BuildMI(MBB, DL, TII.get(Opc)), AM).addReg(Val);
@@ -269,7 +303,8 @@ X86FastISel::X86FastEmitStore(EVT VT, unsigned Val,
 }
 
 bool X86FastISel::X86FastEmitStore(EVT VT, Value *Val,
-                                   const X86AddressMode &AM) {
+                                   const X86AddressMode &AM,
+                                   unsigned Alignment) {
   // Handle 'null' like i32/i64 0.
   if (isa<ConstantPointerNull>(Val))
     Val = Constant::getNullValue(TD.getIntPtrType(Val->getContext()));
@@ -300,7 +335,7 @@ bool X86FastISel::X86FastEmitStore(EVT VT, Value *Val,
   if (ValReg == 0)
     return false;    
  
-  return X86FastEmitStore(VT, ValReg, AM);
+  return X86FastEmitStore(VT, ValReg, AM, Alignment);
 }
 
 /// X86FastEmitExtend - Emit a machine instruction to extend a value Src of
@@ -613,7 +648,11 @@ bool X86FastISel::X86SelectStore(Instruction* I) {
   if (!X86SelectAddress(I->getOperand(1), AM))
     return false;
 
-  return X86FastEmitStore(VT, I->getOperand(0), AM);
+  unsigned Alignment = cast<StoreInst>(I)->getAlignment();
+  if (Alignment == 0)
+    Alignment = TD.getABITypeAlignment(I->getOperand(0)->getType());
+
+  return X86FastEmitStore(VT, I->getOperand(0), AM, Alignment);
 }
 
 /// X86SelectLoad - Select and emit code to implement load instructions.
@@ -627,8 +666,12 @@ bool X86FastISel::X86SelectLoad(Instruction *I)  {
   if (!X86SelectAddress(I->getOperand(0), AM))
     return false;
 
+  unsigned Alignment = cast<LoadInst>(I)->getAlignment();
+  if (Alignment == 0)
+    Alignment = TD.getABITypeAlignment(I->getType());
+
   unsigned ResultReg = 0;
-  if (X86FastEmitLoad(VT, AM, ResultReg)) {
+  if (X86FastEmitLoad(VT, AM, ResultReg, Alignment)) {
     UpdateValueMap(I, ResultReg);
     return true;
   }
@@ -1136,10 +1179,68 @@ bool X86FastISel::X86SelectExtractValue(Instruction *I) {
   return false;
 }
 
+/// IsMemcpySmall - Return true if a copy of Len bytes is short enough to be
+/// expanded into a few scalar loads and stores.
+bool X86FastISel::IsMemcpySmall(uint64_t Len) {
+  return Len <= (Subtarget->is64Bit() ? 32 : 16);
+}
+
+/// TryEmitSmallMemcpy - Emit an inline copy of Len bytes from SrcAM to DestAM
+/// using the widest legal integer loads and stores.  Return false if the copy
+/// is too large to be worth expanding.
+bool X86FastISel::TryEmitSmallMemcpy(X86AddressMode DestAM,
+                                     X86AddressMode SrcAM, uint64_t Len) {
+  // Make sure we don't bloat code by inlining very large memcpy's.
+  if (!IsMemcpySmall(Len))
+    return false;
+
+  bool i64Legal = TLI.isTypeLegal(MVT::i64);
+
+  // We don't care about alignment here since we just emit integer accesses.
+  while (Len) {
+    EVT VT;
+    if (Len >= 8 && i64Legal)
+      VT = MVT::i64;
+    else if (Len >= 4)
+      VT = MVT::i32;
+    else if (Len >= 2)
+      VT = MVT::i16;
+    else
+      VT = MVT::i8;
+
+    unsigned Reg;
+    bool RV = X86FastEmitLoad(VT, SrcAM, Reg);
+    RV &= X86FastEmitStore(VT, Reg, DestAM);
+    assert(RV && "Failed to emit load or store??"); RV=RV;
+
+    unsigned Size = VT.getSizeInBits()/8;
+    Len -= Size;
+    DestAM.Disp += Size;
+    SrcAM.Disp += Size;
+  }
+
+  return true;
+}
+
 bool X86FastISel::X86VisitIntrinsicCall(IntrinsicInst &I) {
   // FIXME: Handle more intrinsics.
   switch (I.getIntrinsicID()) {
   default: return false;
+  case Intrinsic::memcpy: {
+    MemCpyInst &MCI = cast<MemCpyInst>(I);
+    // Only small, constant length copies are expanded inline; everything
+    // else is left to the libcall emitted by SDISel.
+    ConstantInt *Len = dyn_cast<ConstantInt>(MCI.getLength());
+    if (!Len || !IsMemcpySmall(Len->getZExtValue()))
+      return false;
+
+    X86AddressMode DestAM, SrcAM;
+    if (!X86SelectAddress(MCI.getRawDest(), DestAM) ||
+        !X86SelectAddress(MCI.getRawSource(), SrcAM))
+      return false;
+
+    return TryEmitSmallMemcpy(DestAM, SrcAM, Len->getZExtValue());
+  }
   case Intrinsic::sadd_with_overflow:
   case Intrinsic::uadd_with_overflow: {
     // Replace "add with overflow" intrinsics with an "add" instruction followed
@@ -1222,10 +1323,14 @@ bool X86FastISel::X86SelectCall(Instruction *I) {
   if (CC == CallingConv::Fast && PerformTailCallOpt)
     return false;
 
-  // Let SDISel handle vararg functions.
+  // Handle vararg calls to C functions only. Win64 additionally requires
+  // floating point arguments to be shadowed in integer registers, so let
+  // SDISel handle those.
   const PointerType *PT = cast<PointerType>(CS.getCalledValue()->getType());
   const FunctionType *FTy = cast<FunctionType>(PT->getElementType());
-  if (FTy->isVarArg())
+  bool isVarArg = FTy->isVarArg();
+  if (isVarArg &&
+      (CC != CallingConv::C || Subtarget->isTargetWin64()))
     return false;
 
   // Handle *simple* calls for now.
@@ -1281,14 +1386,30 @@ bool X86FastISel::X86SelectCall(Instruction *I) {
     // FIXME: Only handle *easy* calls for now.
     if (CS.paramHasAttr(AttrInd, Attribute::InReg) ||
         CS.paramHasAttr(AttrInd, Attribute::StructRet) ||
-        CS.paramHasAttr(AttrInd, Attribute::Nest) ||
-        CS.paramHasAttr(AttrInd, Attribute::ByVal))
+        CS.paramHasAttr(AttrInd, Attribute::Nest))
       return false;
 
     const Type *ArgTy = (*i)->getType();
     EVT ArgVT;
     if (!isTypeLegal(ArgTy, ArgVT))
       return false;
+
+    // Small byval aggregates are copied into the outgoing argument area with
+    // a few loads and stores; anything larger needs a memcpy call.
+    if (CS.paramHasAttr(AttrInd, Attribute::ByVal)) {
+      if (Subtarget->isTargetWin64())
+        return false;
+      const Type *ElementTy = cast<PointerType>(ArgTy)->getElementType();
+      uint64_t FrameSize = TD.getTypeAllocSize(ElementTy);
+      if (!IsMemcpySmall(FrameSize))
+        return false;
+      unsigned FrameAlign = CS.getParamAlignment(AttrInd);
+      if (FrameAlign == 0)
+        FrameAlign = TLI.getByValTypeAlignment(ElementTy);
+      Flags.setByVal();
+      Flags.setByValSize(FrameSize);
+      Flags.setByValAlign(FrameAlign);
+    }
     unsigned OriginalAlignment = TD.getABITypeAlignment(ArgTy);
     Flags.setOrigAlign(OriginalAlignment);
 
@@ -1300,7 +1421,7 @@ bool X86FastISel::X86SelectCall(Instruction *I) {
 
   // Analyze operands of the call, assigning locations to each operand.
   SmallVector<CCValAssign, 16> ArgLocs;
-  CCState CCInfo(CC, false, TM, ArgLocs, I->getParent()->getContext());
+  CCState CCInfo(CC, isVarArg, TM, ArgLocs, I->getParent()->getContext());
   CCInfo.AnalyzeCallOperands(ArgVTs, ArgFlags, CCAssignFnForCall(CC));
 
   // Get a count of how many bytes are to be pushed on the stack.
@@ -1375,17 +1496,36 @@ bool X86FastISel::X86SelectCall(Instruction *I) {
       AM.Base.Reg = StackPtr;
       AM.Disp = LocMemOffset;
       Value *ArgVal = ArgVals[VA.getValNo()];
+      ISD::ArgFlagsTy Flags = ArgFlags[VA.getValNo()];
       
-      // If this is a really simple value, emit this with the Value* version of
-      // X86FastEmitStore.  If it isn't simple, we don't want to do this, as it
-      // can cause us to reevaluate the argument.
-      if (isa<ConstantInt>(ArgVal) || isa<ConstantPointerNull>(ArgVal))
+      if (Flags.isByVal()) {
+        // Copy the aggregate the argument points to into the stack slot.
+        X86AddressMode SrcAM;
+        SrcAM.Base.Reg = Arg;
+        bool Emitted = TryEmitSmallMemcpy(AM, SrcAM, Flags.getByValSize());
+        assert(Emitted && "Failed to emit a byval copy!"); Emitted=Emitted;
+      } else if (isa<ConstantInt>(ArgVal) || isa<ConstantPointerNull>(ArgVal))
+        // If this is a really simple value, emit this with the Value* version
+        // of X86FastEmitStore.  If it isn't simple, we don't want to do this,
+        // as it can cause us to reevaluate the argument.
         X86FastEmitStore(ArgVT, ArgVal, AM);
       else
         X86FastEmitStore(ArgVT, Arg, AM);
     }
   }
 
+  // For vararg calls on x86-64, %al holds an upper bound on the number of
+  // vector registers used to pass arguments.
+  if (isVarArg && Subtarget->is64Bit()) {
+    static const unsigned XMMArgRegs[] = {
+      X86::XMM0, X86::XMM1, X86::XMM2, X86::XMM3,
+      X86::XMM4, X86::XMM5, X86::XMM6, X86::XMM7
+    };
+    unsigned NumXMMRegs = CCInfo.getFirstUnallocated(XMMArgRegs, 8);
+    BuildMI(MBB, DL, TII.get(X86::MOV8ri), X86::AL).addImm(NumXMMRegs);
+    RegArgs.push_back(X86::AL);
+  }
+
   // ELF / PIC requires GOT in the EBX register before function calls via PLT
   // GOT pointer.  
   if (Subtarget->isPICStyleGOT()) {
@@ -1448,7 +1588,7 @@ bool X86FastISel::X86SelectCall(Instruction *I) {
   // Now handle call return value (if any).
   if (RetVT.getSimpleVT().SimpleTy != MVT::isVoid) {
     SmallVector<CCValAssign, 16> RVLocs;
-    CCState CCInfo(CC, false, TM, RVLocs, I->getParent()->getContext());
+    CCState CCInfo(CC, isVarArg, TM, RVLocs, I->getParent()->getContext());
     CCInfo.AnalyzeCallResult(RetVT, RetCC_X86);
 
     // Copy all of the result registers out of their specified physreg.
@@ -1601,6 +1741,23 @@ unsigned X86FastISel::TargetMaterializeConstant(Constant *C) {
   case MVT::f80:
     // No f80 support yet.
     return false;
+  // Vector constants come from the constant pool, which aligns them to their
+  // size, so the aligned loads can be used.
+  case MVT::v4f32:
+    Opc = X86::MOVAPSrm;
+    RC  = X86::VR128RegisterClass;
+    break;
+  case MVT::v2f64:
+    Opc = X86::MOVAPDrm;
+    RC  = X86::VR128RegisterClass;
+    break;
+  case MVT::v16i8:
+  case MVT::v8i16:
+  case MVT::v4i32:
+  case MVT::v2i64:
+    Opc = X86::MOVDQArm;
+    RC  = X86::VR128RegisterClass;
+    break;
   }
   
   // Materialize addresses with LEA instructions.
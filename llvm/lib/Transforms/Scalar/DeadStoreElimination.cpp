@@ -359,6 +359,8 @@ bool DSE::handleEndBlock(BasicBlock &BB) {
     killPointer = killPointer->getUnderlyingObject();
 
     // Deal with undead pointers
+    if (deadPointers.empty())
+      continue;
     MadeChange |= RemoveUndeadPointers(killPointer, killPointerSize, BBI,
                                        deadPointers);
   }
@@ -72,6 +72,7 @@ STATISTIC(NumConstProp, "Number of constant folds");
 STATISTIC(NumDeadInst , "Number of dead inst eliminated");
 STATISTIC(NumDeadStore, "Number of dead stores eliminated");
 STATISTIC(NumSunkInst , "Number of instructions sunk");
+STATISTIC(NumVisited  , "Number of instructions visited");
 
 namespace {
   class VISIBILITY_HIDDEN InstCombiner
@@ -96,6 +97,20 @@ namespace {
         Worklist.push_back(I);
     }
 
+    /// AddInitialGroupToWorkList - Add the specified batch of distinct
+    /// instructions to an empty worklist, in order.  This avoids the map
+    /// growing repeatedly while the worklist is seeded with a whole function.
+    void AddInitialGroupToWorkList(Instruction *const *List,
+                                   unsigned NumEntries) {
+      assert(Worklist.empty() && "Worklist must be empty to add initial group");
+      Worklist.reserve(NumEntries);
+      WorklistMap.resize(NumEntries*2);
+      for (unsigned i = 0; i != NumEntries; ++i) {
+        WorklistMap.insert(std::make_pair(List[i], i));
+        Worklist.push_back(List[i]);
+      }
+    }
+
     // RemoveFromWorkList - remove I from the worklist if it exists.
     void RemoveFromWorkList(Instruction *I) {
       DenseMap<Instruction*, unsigned>::iterator It = WorklistMap.find(I);
@@ -12905,6 +12920,11 @@ static void AddReachableCodeToWorklist(BasicBlock *BB,
   SmallVector<BasicBlock*, 256> Worklist;
   Worklist.push_back(BB);
 
+  // Collect the instructions to combine first and hand them to the worklist
+  // in one batch once the walk is done.  Each block is only visited once, so
+  // there are no duplicates.
+  SmallVector<Instruction*, 128> InstrsForInstCombineWorklist;
+
   while (!Worklist.empty()) {
     BB = Worklist.back();
     Worklist.pop_back();
@@ -12941,7 +12961,9 @@ static void AddReachableCodeToWorklist(BasicBlock *BB,
         if (DBI_Prev
             && DBI_Prev->getIntrinsicID() == llvm::Intrinsic::dbg_stoppoint
             && DBI_Next->getIntrinsicID() == llvm::Intrinsic::dbg_stoppoint) {
-          IC.RemoveFromWorkList(DBI_Prev);
+          // DBI_Prev is always the last instruction collected so far.
+          assert(InstrsForInstCombineWorklist.back() == DBI_Prev);
+          InstrsForInstCombineWorklist.pop_back();
           DBI_Prev->eraseFromParent();
         }
         DBI_Prev = DBI_Next;
@@ -12949,7 +12971,7 @@ static void AddReachableCodeToWorklist(BasicBlock *BB,
         DBI_Prev = 0;
       }
 
-      IC.AddToWorkList(Inst);
+      InstrsForInstCombineWorklist.push_back(Inst);
     }
 
     // Recursively visit successors.  If this is a branch or switch on a
@@ -12981,6 +13003,10 @@ static void AddReachableCodeToWorklist(BasicBlock *BB,
     for (unsigned i = 0, e = TI->getNumSuccessors(); i != e; ++i)
       Worklist.push_back(TI->getSuccessor(i));
   }
+
+  if (!InstrsForInstCombineWorklist.empty())
+    IC.AddInitialGroupToWorkList(&InstrsForInstCombineWorklist[0],
+                                 InstrsForInstCombineWorklist.size());
 }
 
 bool InstCombiner::DoOneIteration(Function &F, unsigned Iteration) {
@@ -13023,6 +13049,7 @@ bool InstCombiner::DoOneIteration(Function &F, unsigned Iteration) {
   while (!Worklist.empty()) {
     Instruction *I = RemoveOneFromWorkList();
     if (I == 0) continue;  // skip null values.
+    ++NumVisited;
 
     // Check to see if we can DCE the instruction.
     if (isInstructionTriviallyDead(I)) {
@@ -24,6 +24,7 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/LoopPass.h"
+#include "llvm/Analysis/ScalarEvolution.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
@@ -167,6 +168,13 @@ bool llvm::UnrollLoop(Loop *L, unsigned Count, LoopInfo* LI, LPPassManager* LPM)
     DOUT << "!\n";
   }
 
+  // Notify ScalarEvolution that the loop will be substantially changed, if
+  // not outright eliminated, so that it can drop what it knows about this
+  // loop while keeping its results for the rest of the function.
+  if (LPM)
+    if (ScalarEvolution *SE = LPM->getAnalysisIfAvailable<ScalarEvolution>())
+      SE->forgetLoopBackedgeTakenCount(L);
+
   std::vector<BasicBlock*> LoopBlocks = L->getBlocks();
 
   bool ContinueOnTrue = L->contains(BI->getSuccessor(0));
@@ -229,7 +229,6 @@ ConstantInt::ConstantInt(const IntegerType *Ty, const APInt& V)
 
 ConstantInt* ConstantInt::getTrue(LLVMContext &Context) {
   LLVMContextImpl *pImpl = Context.pImpl;
-  sys::SmartScopedWriter<true>(pImpl->ConstantsLock);
   if (pImpl->TheTrueVal)
     return pImpl->TheTrueVal;
   else
@@ -239,7 +238,6 @@ ConstantInt* ConstantInt::getTrue(LLVMContext &Context) {
 
 ConstantInt* ConstantInt::getFalse(LLVMContext &Context) {
   LLVMContextImpl *pImpl = Context.pImpl;
-  sys::SmartScopedWriter<true>(pImpl->ConstantsLock);
   if (pImpl->TheFalseVal)
     return pImpl->TheFalseVal;
   else
@@ -258,22 +256,23 @@ ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt& V) {
   const IntegerType *ITy = IntegerType::get(Context, V.getBitWidth());
   // get an existing value or the insertion position
   DenseMapAPIntKeyInfo::KeyTy Key(V, ITy);
-  
-  Context.pImpl->ConstantsLock.reader_acquire();
-  ConstantInt *&Slot = Context.pImpl->IntConstants[Key]; 
-  Context.pImpl->ConstantsLock.reader_release();
-    
-  if (!Slot) {
-    sys::SmartScopedWriter<true> Writer(Context.pImpl->ConstantsLock);
-    ConstantInt *&NewSlot = Context.pImpl->IntConstants[Key]; 
-    if (!Slot) {
-      NewSlot = new ConstantInt(ITy, V);
-    }
-    
-    return NewSlot;
-  } else {
-    return Slot;
-  }
+  LLVMContextImpl *pImpl = Context.pImpl;
+
+  // Most requests are for constants that already exist, so only look them up
+  // under the reader lock; the map must not be modified while it is shared.
+  pImpl->ConstantsLock.reader_acquire();
+  LLVMContextImpl::IntMapTy::iterator I = pImpl->IntConstants.find(Key);
+  ConstantInt *Result = I != pImpl->IntConstants.end() ? I->second : 0;
+  pImpl->ConstantsLock.reader_release();
+
+  if (Result)
+    return Result;
+
+  sys::SmartScopedWriter<true> Writer(pImpl->ConstantsLock);
+  ConstantInt *&Slot = pImpl->IntConstants[Key];
+  if (!Slot)
+    Slot = new ConstantInt(ITy, V);
+  return Slot;
 }
 
 Constant* ConstantInt::get(const Type* Ty, uint64_t V, bool isSigned) {
@@ -402,8 +401,11 @@ ConstantFP* ConstantFP::get(LLVMContext &Context, const APFloat& V) {
   
   LLVMContextImpl* pImpl = Context.pImpl;
   
+  // See ConstantInt::get: look up existing constants under the reader lock
+  // and only take the writer lock to create a new one.
   pImpl->ConstantsLock.reader_acquire();
-  ConstantFP *&Slot = pImpl->FPConstants[Key];
+  LLVMContextImpl::FPMapTy::iterator I = pImpl->FPConstants.find(Key);
+  ConstantFP *Slot = I != pImpl->FPConstants.end() ? I->second : 0;
   pImpl->ConstantsLock.reader_release();
     
   if (!Slot) {
@@ -205,7 +205,7 @@ public:
 
   inline void addTopLevelPass(Pass *P) {
 
-    if (ImmutablePass *IP = dynamic_cast<ImmutablePass *> (P)) {
+    if (ImmutablePass *IP = P->getAsImmutablePass()) {
       
       // P is a immutable pass and it will be managed by this
       // top level manager. Set up analysis resolver to connect them.
@@ -335,7 +335,7 @@ public:
   }
 
   inline void addTopLevelPass(Pass *P) {
-    if (ImmutablePass *IP = dynamic_cast<ImmutablePass *> (P)) {
+    if (ImmutablePass *IP = P->getAsImmutablePass()) {
       
       // P is a immutable pass and it will be managed by this
       // top level manager. Set up analysis resolver to connect them.
@@ -420,6 +420,7 @@ static TimingInfo *TheTimeInfo;
 
 /// Initialize top level manager. Create first pass manager.
 PMTopLevelManager::PMTopLevelManager(enum TopLevelManagerType t) {
+  InversedLastUserIsStale = true;
   if (t == TLM_Pass) {
     MPPassManager *MPP = new MPPassManager(1);
     MPP->setTopLevelManager(this);
@@ -436,6 +437,7 @@ PMTopLevelManager::PMTopLevelManager(enum TopLevelManagerType t) {
 /// Set pass P as the last user of the given analysis passes.
 void PMTopLevelManager::setLastUser(SmallVector<Pass *, 12> &AnalysisPasses, 
                                     Pass *P) {
+  InversedLastUserIsStale = true;
   for (SmallVector<Pass *, 12>::iterator I = AnalysisPasses.begin(),
          E = AnalysisPasses.end(); I != E; ++I) {
     Pass *AP = *I;
@@ -621,6 +623,13 @@ void PMTopLevelManager::initializeAllAnalysisInfo() {
          E = IndirectPassManagers.end(); I != E; ++I)
     (*I)->initializeAnalysisInfo();
 
+  // The inverse map only depends on LastUser, so reuse it across runs unless
+  // new passes were scheduled in the meantime.
+  if (!InversedLastUserIsStale)
+    return;
+  InversedLastUserIsStale = false;
+  InversedLastUser.clear();
+
   for (DenseMap<Pass *, Pass *>::iterator DMI = LastUser.begin(),
         DME = LastUser.end(); DMI != DME; ++DMI) {
     DenseMap<Pass *, SmallPtrSet<Pass *, 8> >::iterator InvDMI = 
@@ -678,7 +687,7 @@ bool PMDataManager::preserveHigherLevelAnalysis(Pass *P) {
   for (SmallVector<Pass *, 8>::iterator I = HigherLevelAnalysis.begin(),
          E = HigherLevelAnalysis.end(); I  != E; ++I) {
     Pass *P1 = *I;
-    if (!dynamic_cast<ImmutablePass*>(P1) &&
+    if (!P1->getAsImmutablePass() &&
         std::find(PreservedSet.begin(), PreservedSet.end(),
                   P1->getPassInfo()) == 
            PreservedSet.end())
@@ -755,7 +764,7 @@ void PMDataManager::removeNotPreservedAnalysis(Pass *P) {
   for (std::map<AnalysisID, Pass*>::iterator I = AvailableAnalysis.begin(),
          E = AvailableAnalysis.end(); I != E; ) {
     std::map<AnalysisID, Pass*>::iterator Info = I++;
-    if (!dynamic_cast<ImmutablePass*>(Info->second)
+    if (!Info->second->getAsImmutablePass()
         && std::find(PreservedSet.begin(), PreservedSet.end(), Info->first) == 
         PreservedSet.end()) {
       // Remove this analysis
@@ -779,7 +788,7 @@ void PMDataManager::removeNotPreservedAnalysis(Pass *P) {
            I = InheritedAnalysis[Index]->begin(),
            E = InheritedAnalysis[Index]->end(); I != E; ) {
       std::map<AnalysisID, Pass *>::iterator Info = I++;
-      if (!dynamic_cast<ImmutablePass*>(Info->second) &&
+      if (!Info->second->getAsImmutablePass() &&
           std::find(PreservedSet.begin(), PreservedSet.end(), Info->first) == 
              PreservedSet.end())
         // Remove this analysis
@@ -0,0 +1,38 @@
+; RUN: llvm-as < %s | llc -fast-isel -fast-isel-verbose -mtriple=x86_64-linux-gnu |& FileCheck %s -check-prefix=LINUX
+; RUN: llvm-as < %s | llc -fast-isel -fast-isel-verbose -mtriple=x86_64-linux-gnu |& not grep {missed call:.*takes_pair\|missed call:.*printf}
+; RUN: llvm-as < %s | llc -fast-isel -fast-isel-verbose -mtriple=x86_64-pc-mingw64 |& FileCheck %s -check-prefix=WIN64
+
+; Calls that the "fast" instruction selector leaves to SelectionDAG: vararg
+; calls and byval arguments on Win64, and memcpys over the inline limit.
+
+%struct.pair = type { i32, i32 }
+
+@.str = internal constant [4 x i8] c"%f\0A\00"
+
+declare i32 @printf(i8*, ...)
+
+; WIN64: FastISel missed call:   %0 = call i32 (i8*, ...)* @printf
+define void @varargs(double %y) nounwind {
+entry:
+  %0 = call i32 (i8*, ...)* @printf(i8* getelementptr ([4 x i8]* @.str, i32 0, i32 0), double %y)
+  ret void
+}
+
+declare void @takes_pair(%struct.pair* byval)
+
+; WIN64: FastISel missed call:   call void @takes_pair
+define void @byval(%struct.pair* %p) nounwind {
+entry:
+  call void @takes_pair(%struct.pair* byval %p)
+  ret void
+}
+
+declare void @llvm.memcpy.i32(i8*, i8*, i32, i32)
+
+; LINUX: FastISel missed call:   call void @llvm.memcpy.i32(i8* %d, i8* %s, i32 64, i32 4)
+; WIN64: FastISel missed call:   call void @llvm.memcpy.i32(i8* %d, i8* %s, i32 64, i32 4)
+define void @big_memcpy(i8* %d, i8* %s) nounwind {
+entry:
+  call void @llvm.memcpy.i32(i8* %d, i8* %s, i32 64, i32 4)
+  ret void
+}
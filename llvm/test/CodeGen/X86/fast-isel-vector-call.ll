@@ -0,0 +1,96 @@
+; RUN: llvm-as < %s | llc -fast-isel -fast-isel-verbose -mtriple=x86_64-linux-gnu |& not grep {FastISel miss}
+; RUN: llvm-as < %s | llc -fast-isel -fast-isel-verbose -mtriple=i686-linux-gnu -mattr=+sse2 |& not grep {FastISel miss}
+; RUN: llvm-as < %s | llc -fast-isel -mtriple=x86_64-linux-gnu | FileCheck %s -check-prefix=X64
+; RUN: llvm-as < %s | llc -fast-isel -mtriple=i686-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=X32
+
+; Vector arithmetic, vararg calls, small byval arguments and small memcpys
+; should all stay on the "fast" instruction selection path.
+
+%struct.pair = type { i32, i32 }
+
+@.str = internal constant [7 x i8] c"%d %f\0A\00"
+
+; The aligned move is only used when the access is 16-byte aligned.
+; X64: vadd:
+; X64: movaps (%rdi), %xmm0
+; X64-NEXT: movups (%rsi), %xmm1
+; X64: movaps %xmm0, (%rdi)
+; X32: vadd:
+; X32: movaps (%ecx), %xmm0
+; X32-NEXT: movups (%eax), %xmm1
+define void @vadd(<4 x float>* %p, <4 x float>* %q) nounwind {
+entry:
+  %a = load <4 x float>* %p
+  %b = load <4 x float>* %q, align 4
+  %c = fadd <4 x float> %a, %b
+  %d = fmul <4 x float> %c, <float 1.0, float 2.0, float 3.0, float 4.0>
+  store <4 x float> %d, <4 x float>* %p
+  ret void
+}
+
+; X64: iadd:
+; X64: movdqa (%rdi), %xmm0
+; X64: movdqu %xmm0, (%rdi)
+define void @iadd(<4 x i32>* %p) nounwind {
+entry:
+  %a = load <4 x i32>* %p
+  %b = add <4 x i32> %a, %a
+  store <4 x i32> %b, <4 x i32>* %p, align 8
+  ret void
+}
+
+declare i32 @printf(i8*, ...)
+
+; On x86-64 %al holds the number of vector registers used by the call.
+; X64: varargs:
+; X64: movb $1, %al
+; X64-NEXT: call printf
+; X32: varargs:
+; X32: movsd %xmm0, 8(%esp)
+; X32-NEXT: call printf
+define void @varargs(i32 %x, double %y) nounwind {
+entry:
+  %0 = call i32 (i8*, ...)* @printf(i8* getelementptr ([7 x i8]* @.str, i32 0, i32 0), i32 %x, double %y)
+  ret void
+}
+
+declare void @takes_pair(%struct.pair* byval)
+
+; The byval copy goes straight into the outgoing argument area.
+; X64: byval:
+; X64: movq (%rdi), %rax
+; X64-NEXT: movq %rax, (%rsp)
+; X64-NEXT: call takes_pair
+; X32: byval:
+; X32: movl (%eax), %ecx
+; X32-NEXT: movl %ecx, (%esp)
+; X32-NEXT: movl 4(%eax), %eax
+; X32-NEXT: movl %eax, 4(%esp)
+; X32-NEXT: call takes_pair
+define void @byval(%struct.pair* %p) nounwind {
+entry:
+  call void @takes_pair(%struct.pair* byval %p)
+  ret void
+}
+
+declare void @llvm.memcpy.i32(i8*, i8*, i32, i32)
+
+; X64: small_memcpy:
+; X64: movq (%rsi), %rax
+; X64-NEXT: movq %rax, (%rdi)
+; X64-NEXT: movl 8(%rsi), %eax
+; X64-NEXT: movl %eax, 8(%rdi)
+; X64-NEXT: ret
+; X32: small_memcpy:
+; X32: movl (%eax), %edx
+; X32-NEXT: movl %edx, (%ecx)
+; X32-NEXT: movl 4(%eax), %edx
+; X32-NEXT: movl %edx, 4(%ecx)
+; X32-NEXT: movl 8(%eax), %eax
+; X32-NEXT: movl %eax, 8(%ecx)
+; X32-NEXT: ret
+define void @small_memcpy(i8* %d, i8* %s) nounwind {
+entry:
+  call void @llvm.memcpy.i32(i8* %d, i8* %s, i32 12, i32 4)
+  ret void
+}
@@ -0,0 +1,13 @@
+; RUN: llvm-as < %s | opt -dse | llvm-dis | not grep DEAD
+
+; The call makes %a live, but DSE must keep scanning the block upwards and
+; delete the dead load above it.
+
+declare void @g(i32*)
+
+define void @f(i32* %p) {
+        %a = alloca i32         ; <i32*> [#uses=1]
+        %DEAD = load i32* %p            ; <i32> [#uses=0]
+        call void @g(i32* %a)
+        ret void
+}
@@ -0,0 +1,48 @@
+; RUN: llvm-as < %s | opt -gvn | llvm-dis > %t
+; RUN: grep {%v = phi i32} %t
+; RUN: grep {ret i32 7} %t
+; RUN: llvm-as < %s | opt -gvn -memdep-nonlocal-block-limit=2 | llvm-dis > %t
+; RUN: grep {%v = load i32} %t
+; RUN: grep {%w = load i32} %t
+
+define i32 @test(i32 %x, i32* %p) nounwind {
+entry:
+	switch i32 %x, label %bb0 [
+		i32 1, label %bb1
+		i32 2, label %bb2
+	]
+
+bb0:
+	store i32 0, i32* %p
+	br label %join
+
+bb1:
+	store i32 1, i32* %p
+	br label %join
+
+bb2:
+	store i32 2, i32* %p
+	br label %join
+
+join:
+	%v = load i32* %p
+	ret i32 %v
+}
+
+; Transparent blocks count against the limit too, even though they do not
+; add any results.
+define i32 @transparent(i1 %c, i32* %p) nounwind {
+entry:
+	store i32 7, i32* %p
+	br i1 %c, label %a, label %b
+
+a:
+	br label %join
+
+b:
+	br label %join
+
+join:
+	%w = load i32* %p
+	ret i32 %w
+}
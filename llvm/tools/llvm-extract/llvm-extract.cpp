@@ -14,6 +14,7 @@
 
 #include "llvm/LLVMContext.h"
 #include "llvm/Module.h"
+#include "llvm/ModuleProvider.h"
 #include "llvm/PassManager.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/Transforms/IPO.h"
@@ -65,29 +66,33 @@ int main(int argc, char **argv) {
   llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
   cl::ParseCommandLineOptions(argc, argv, "llvm extractor\n");
 
-  std::auto_ptr<Module> M;
+  std::auto_ptr<ModuleProvider> MP;
   
   MemoryBuffer *Buffer = MemoryBuffer::getFileOrSTDIN(InputFilename);
   if (Buffer == 0) {
     errs() << argv[0] << ": Error reading file '" + InputFilename + "'\n";
     return 1;
-  } else {
-    M.reset(ParseBitcodeFile(Buffer, Context));
   }
-  delete Buffer;
-  
-  if (M.get() == 0) {
+
+  // Only read in the module-level information up front; function bodies are
+  // deserialized on demand below.  On success the provider owns Buffer.
+  std::string ErrorMessage;
+  MP.reset(getBitcodeModuleProvider(Buffer, Context, &ErrorMessage));
+  if (MP.get() == 0) {
+    delete Buffer;
     errs() << argv[0] << ": bitcode didn't read correctly.\n";
+    errs() << "Reason: " << ErrorMessage << "\n";
     return 1;
   }
+  Module *M = MP->getModule();
 
   // Figure out which function we should extract
   GlobalVariable *G = !ExtractGlobal.empty() ?
-    M.get()->getNamedGlobal(ExtractGlobal) : 0;
+    M->getNamedGlobal(ExtractGlobal) : 0;
 
   // Figure out which function we should extract
   if (ExtractFunc.empty() && ExtractGlobal.empty()) ExtractFunc = "main";
-  Function *F = M.get()->getFunction(ExtractFunc);
+  Function *F = M->getFunction(ExtractFunc);
 
   if (F == 0 && G == 0) {
     errs() << argv[0] << ": program doesn't contain function named '"
@@ -95,10 +100,21 @@ int main(int argc, char **argv) {
     return 1;
   }
 
+  // When deleting, every other function keeps its body, so the whole module
+  // has to be read.  When isolating, all other functions are replaced by
+  // declarations, so only the body of the extracted function is needed.
+  bool ReadFailed = DeleteFn ? MP->materializeModule(&ErrorMessage) == 0
+                             : F && MP->materializeFunction(F, &ErrorMessage);
+  if (ReadFailed) {
+    errs() << argv[0] << ": bitcode didn't read correctly.\n";
+    errs() << "Reason: " << ErrorMessage << "\n";
+    return 1;
+  }
+
   // In addition to deleting all other functions, we also want to spiff it
   // up a little bit.  Do this now.
   PassManager Passes;
-  Passes.add(new TargetData(M.get())); // Use correct TargetData
+  Passes.add(new TargetData(M)); // Use correct TargetData
   // Either isolate the function or delete it from the Module
   std::vector<GlobalValue*> GVs;
   if (F) GVs.push_back(F);
@@ -129,7 +145,7 @@ int main(int argc, char **argv) {
   }
 
   Passes.add(createBitcodeWriterPass(*Out));
-  Passes.run(*M.get());
+  Passes.run(*M);
 
   if (Out != &outs())
     delete Out;
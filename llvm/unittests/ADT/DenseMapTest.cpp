@@ -97,6 +97,23 @@ TEST_F(DenseMapTest, ClearTest) {
   EXPECT_TRUE(uintMap.begin() == uintMap.end());
 }
 
+// Test clear() on maps that are already empty
+TEST_F(DenseMapTest, ClearEmptyTest) {
+  uintMap.clear();
+  EXPECT_TRUE(uintMap.empty());
+
+  // A map with only erased entries left still needs its tombstones cleared.
+  uintMap[0] = 1;
+  uintMap.erase(0);
+  uintMap.clear();
+  EXPECT_TRUE(uintMap.empty());
+  EXPECT_TRUE(uintMap.begin() == uintMap.end());
+
+  uintMap[0] = 2;
+  EXPECT_EQ(1u, uintMap.size());
+  EXPECT_EQ(2u, uintMap[0]);
+}
+
 // Test erase(iterator) method
 TEST_F(DenseMapTest, EraseTest) {
   uintMap[0] = 1;
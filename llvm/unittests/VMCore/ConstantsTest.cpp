@@ -109,5 +109,24 @@ TEST(ConstantsTest, IntSigns) {
   EXPECT_EQ(0x3b, ConstantInt::get(Int8Ty, 0x13b)->getSExtValue());
 }
 
+TEST(ConstantsTest, Uniquing) {
+  LLVMContext &Context = getGlobalContext();
+  const IntegerType* Int32Ty = Type::getInt32Ty(Context);
+  const IntegerType* Int64Ty = Type::getInt64Ty(Context);
+
+  // Equal values of the same type must produce the same object.
+  EXPECT_EQ(ConstantInt::get(Int32Ty, 12345), ConstantInt::get(Int32Ty, 12345));
+  EXPECT_NE(ConstantInt::get(Int32Ty, 12345), ConstantInt::get(Int64Ty, 12345));
+  EXPECT_EQ(ConstantInt::getTrue(Context),
+            ConstantInt::get(Type::getInt1Ty(Context), 1));
+  EXPECT_EQ(ConstantInt::getFalse(Context),
+            ConstantInt::get(Type::getInt1Ty(Context), 0));
+
+  EXPECT_EQ(ConstantFP::get(Context, APFloat(2.5)),
+            ConstantFP::get(Context, APFloat(2.5)));
+  EXPECT_NE(ConstantFP::get(Context, APFloat(2.5)),
+            ConstantFP::get(Context, APFloat(2.5f)));
+}
+
 }  // end anonymous namespace
 }  // end namespace llvm